@@ -7,12 +7,134 @@
 #include <cstdlib>
 #include <ctime>
 #include <cctype>
+#include <cmath>
+#include <climits>
+#include <chrono>
+#include <unordered_map>
+#include <thread>
+#include <cstdint>
+#include <list>
+#include <sstream>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 using namespace std;
 
-class Order;
+// ASCII case folding, 32 or 16 bytes at a time when AVX2/SSE2 is available.
+// Bytes outside 'a'..'z' (including UTF-8 bytes >= 0x80) are left untouched,
+// which matches std::toupper in the "C" locale.
+
+#if defined(__SSE2__)
+static inline __m128i upperCase16(__m128i chunk)
+{
+    const __m128i belowA = _mm_set1_epi8('a' - 1);
+    const __m128i aboveZ = _mm_set1_epi8('z' + 1);
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+    __m128i isLower = _mm_and_si128(_mm_cmpgt_epi8(chunk, belowA), _mm_cmplt_epi8(chunk, aboveZ));
+    return _mm_xor_si128(chunk, _mm_and_si128(isLower, caseBit));
+}
+#endif
+
+#if defined(__AVX2__)
+static inline __m256i upperCase32(__m256i chunk)
+{
+    const __m256i belowA = _mm256_set1_epi8('a' - 1);
+    const __m256i aboveZ = _mm256_set1_epi8('z' + 1);
+    const __m256i caseBit = _mm256_set1_epi8(0x20);
+    __m256i isLower = _mm256_and_si256(_mm256_cmpgt_epi8(chunk, belowA), _mm256_cmpgt_epi8(aboveZ, chunk));
+    return _mm256_xor_si256(chunk, _mm256_and_si256(isLower, caseBit));
+}
+#endif
+
+static inline char upperCaseChar(char ch)
+{
+    return (ch >= 'a' && ch <= 'z') ? static_cast<char>(ch - ('a' - 'A')) : ch;
+}
+
+// Converts str to uppercase without allocating
+void toUpperCaseInPlace(string& str)
+{
+    char* data = &str[0];
+    size_t size = str.size();
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    for (; i + 32 <= size; i += 32)
+    {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), upperCase32(chunk));
+    }
+#endif
+#if defined(__SSE2__)
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), upperCase16(chunk));
+    }
+#endif
+    for (; i < size; ++i)
+    {
+        data[i] = upperCaseChar(data[i]);
+    }
+}
+
+// Compares two strings ignoring ASCII case, without building copies
+bool equalsIgnoreCase(const string& a, const string& b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+
+    const char* left = a.data();
+    const char* right = b.data();
+    size_t size = a.size();
+    size_t i = 0;
 
-vector<Order> orderList;
+#if defined(__AVX2__)
+    for (; i + 32 <= size; i += 32)
+    {
+        __m256i x = upperCase32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + i)));
+        __m256i y = upperCase32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(right + i)));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)) != -1)
+        {
+            return false;
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i x = upperCase16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(left + i)));
+        __m128i y = upperCase16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(right + i)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) != 0xFFFF)
+        {
+            return false;
+        }
+    }
+#endif
+    for (; i < size; ++i)
+    {
+        if (upperCaseChar(left[i]) != upperCaseChar(right[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Incremented every time a bulk update commits new prices or stock
+unsigned long catalogVersion = 0;
 
 class Product
 {
@@ -29,7 +151,7 @@ public:
         : productID(id), name(name), price(price), stockQuantity(stock), category(cat) {}
 
     // Getters
-    string getProductID() const { return productID; }
+    const string& getProductID() const { return productID; }
     string getName() const { return name; }
     double getPrice() const { return price; }
     int getStockQuantity() const { return stockQuantity; }
@@ -41,6 +163,9 @@ public:
     void setCategory(const string& newCategory) { category = newCategory; }
 
     void decreaseStock(int quantity) { stockQuantity -= quantity; }
+
+    // Stores the ID in uppercase so lookups can compare it directly
+    void normalizeID() { toUpperCaseInPlace(productID); }
 };
 
 class ShoppingCart
@@ -49,10 +174,11 @@ private:
     int cartID;
     vector<pair<Product, int>> items;
     double totalPrice;
+    unsigned long revision;
 
 public:
     // Constructor
-    ShoppingCart(int id) : cartID(id), totalPrice(0) {}
+    ShoppingCart(int id) : cartID(id), totalPrice(0), revision(0) {}
 
     // To add and remove products
     void addProduct(const Product& product, int quantity = 1)
@@ -71,106 +197,920 @@ public:
             items.push_back({product, quantity});
         }
         totalPrice += product.getPrice() * quantity;
+        ++revision;
+    }
+
+    // Empties the cart; the revision keeps counting so the change is still visible
+    void clear()
+    {
+        items.clear();
+        totalPrice = 0;
+        ++revision;
+    }
+
+    double getTotalPrice() const { return totalPrice; }
+    int getCartID() const { return cartID; }
+    unsigned long getRevision() const { return revision; }
+    vector<pair<Product, int>> getItems() const { return items; }
+};
+
+class Customer
+{
+private:
+    int customerID;
+    string name;
+    string email;
+    string address;
+
+public:
+    // Constructor
+    Customer(int id, string name, string email, string address)
+        : customerID(id), name(name), email(email), address(address) {}
+
+    // Getters
+    int getCustomerID() const { return customerID; }
+    string getName() const { return name; }
+    string getEmail() const { return email; }
+    string getAddress() const { return address; }
+
+    // Setters
+    void setAddress(const string& newAddress) { address = newAddress; }
+
+    // To interact with the cart
+    void addToCart(Product product, ShoppingCart& cart, int quantity = 1)
+    {
+        cart.addProduct(product, quantity);
+    }
+
+    void placeOrder(const ShoppingCart& cart)
+    {
+        cout << "Order placed! Total Price: " << cart.getTotalPrice() << endl;
+    }
+};
+
+// Order dates are stored as YYYYMMDD integers so they sort and index cheaply
+int currentOrderDate()
+{
+    time_t now = time(0);
+    tm* ltm = localtime(&now);
+    return (1900 + ltm->tm_year) * 10000 + (ltm->tm_mon + 1) * 100 + ltm->tm_mday;
+}
+
+string formatOrderDate(int date)
+{
+    int month = date / 100 % 100;
+    int day = date % 100;
+    return to_string(date / 10000) + "-"
+         + (month < 10 ? "0" : "") + to_string(month) + "-"
+         + (day < 10 ? "0" : "") + to_string(day);
+}
+
+// One product in an order, referencing the catalog by position
+struct OrderLine
+{
+    uint32_t productIndex;
+    int quantity;
+    double unitPrice;
+};
+
+class Order
+{
+private:
+    int orderID;
+    int customerID;
+    int orderDate;
+    uint32_t firstLine;
+    uint32_t lineCount;
+    double totalAmount;
+
+public:
+    // Constructor (the lines themselves live in the OrderStore)
+    Order(int id, int custID, int date, uint32_t first, uint32_t count, double total)
+        : orderID(id), customerID(custID), orderDate(date), firstLine(first), lineCount(count), totalAmount(total) {}
+
+    // Getters
+    int getOrderID() const { return orderID; }
+    int getCustomerID() const { return customerID; }
+    int getOrderDate() const { return orderDate; }
+    uint32_t getFirstLine() const { return firstLine; }
+    uint32_t getLineCount() const { return lineCount; }
+    double getTotalAmount() const { return totalAmount; }
+};
+
+// Renders an invoice from order lines alone, so it needs no OrderStore access
+string renderInvoiceLines(int orderID, int orderDate, const OrderLine* lines, size_t lineCount, const vector<Product>& catalog)
+{
+    ostringstream out;
+    out << "=========================" << endl;
+    out << "        Invoice          " << endl;
+    out << "=========================" << endl;
+    out << "Order ID:  " << orderID << endl;
+    out << "Order Date: " << formatOrderDate(orderDate) << endl;
+    out << "Order Details:" << endl;
+    out << left;
+    out << setw(12) << "Product ID" << setw(25) << "Name" << setw(10) << "Price" << setw(10) << "Quantity" << "Total" << endl;
+    out << "----------------------------------------------" << endl;
+
+    double totalAmount = 0;
+    for (size_t i = 0; i < lineCount; ++i)
+    {
+        const OrderLine& line = lines[i];
+        const Product& product = catalog[line.productIndex];
+        out << setw(12) << product.getProductID()
+            << setw(25) << product.getName()
+            << setw(10) << fixed << setprecision(2) << line.unitPrice
+            << setw(10) << line.quantity
+            << setw(10) << fixed << setprecision(2) << line.unitPrice * line.quantity << endl;
+        totalAmount += line.unitPrice * line.quantity;
+    }
+    out << "----------------------------------------------" << endl;
+    out << "Total Amount: " << fixed << setprecision(2) << totalAmount << endl;
+    out << "=========================" << endl;
+    return out.str();
+}
+
+// Append-only order storage with posting lists of order IDs per customer and per date.
+// Order IDs are assigned sequentially, so every posting list is sorted.
+class OrderStore
+{
+private:
+    vector<Order> orders;
+    vector<OrderLine> lines;
+    unordered_map<int, vector<uint32_t>> byCustomer;
+    map<int, vector<uint32_t>> byDate;
+    const vector<uint32_t> noOrders;
+
+public:
+    void reserve(size_t orderCount, size_t lineCount)
+    {
+        orders.reserve(orderCount);
+        lines.reserve(lineCount);
+    }
+
+    const Order& addOrder(int customerID, int orderDate, const vector<OrderLine>& orderLines)
+    {
+        uint32_t orderID = static_cast<uint32_t>(orders.size() + 1);
+        uint32_t firstLine = static_cast<uint32_t>(lines.size());
+        double total = 0;
+        for (const auto& line : orderLines)
+        {
+            lines.push_back(line);
+            total += line.unitPrice * line.quantity;
+        }
+
+        orders.emplace_back(orderID, customerID, orderDate, firstLine, static_cast<uint32_t>(orderLines.size()), total);
+        byCustomer[customerID].push_back(orderID);
+        byDate[orderDate].push_back(orderID);
+        return orders.back();
+    }
+
+    size_t size() const { return orders.size(); }
+
+    // Appends another store's orders, renumbering them after this store's own
+    void append(const OrderStore& other)
+    {
+        orders.reserve(orders.size() + other.orders.size());
+        lines.reserve(lines.size() + other.lines.size());
+        for (const auto& order : other.orders)
+        {
+            uint32_t orderID = static_cast<uint32_t>(orders.size() + 1);
+            uint32_t firstLine = static_cast<uint32_t>(lines.size());
+            auto source = other.lines.begin() + order.getFirstLine();
+            lines.insert(lines.end(), source, source + order.getLineCount());
+
+            orders.emplace_back(orderID, order.getCustomerID(), order.getOrderDate(), firstLine, order.getLineCount(), order.getTotalAmount());
+            byCustomer[order.getCustomerID()].push_back(orderID);
+            byDate[order.getOrderDate()].push_back(orderID);
+        }
+    }
+
+    const Order* findOrder(int orderID) const
+    {
+        if (orderID < 1 || static_cast<size_t>(orderID) > orders.size())
+        {
+            return nullptr;
+        }
+        return &orders[orderID - 1];
+    }
+
+    const OrderLine* getLines(const Order& order) const { return lines.data() + order.getFirstLine(); }
+
+    const vector<uint32_t>& ordersForCustomer(int customerID) const
+    {
+        auto it = byCustomer.find(customerID);
+        return it == byCustomer.end() ? noOrders : it->second;
+    }
+
+    const vector<uint32_t>& ordersOnDate(int orderDate) const
+    {
+        auto it = byDate.find(orderDate);
+        return it == byDate.end() ? noOrders : it->second;
+    }
+
+    vector<uint32_t> ordersForCustomerOnDate(int customerID, int orderDate) const
+    {
+        // Walk the shorter posting list and check the other key on the order itself
+        const vector<uint32_t>& customerOrders = ordersForCustomer(customerID);
+        const vector<uint32_t>& dateOrders = ordersOnDate(orderDate);
+        vector<uint32_t> result;
+        if (customerOrders.size() <= dateOrders.size())
+        {
+            for (uint32_t orderID : customerOrders)
+            {
+                if (orders[orderID - 1].getOrderDate() == orderDate)
+                {
+                    result.push_back(orderID);
+                }
+            }
+        }
+        else
+        {
+            for (uint32_t orderID : dateOrders)
+            {
+                if (orders[orderID - 1].getCustomerID() == customerID)
+                {
+                    result.push_back(orderID);
+                }
+            }
+        }
+        return result;
+    }
+
+    string renderInvoice(const Order& order, const vector<Product>& catalog) const
+    {
+        return renderInvoiceLines(order.getOrderID(), order.getOrderDate(), getLines(order), order.getLineCount(), catalog);
+    }
+};
+
+OrderStore orderStore;
+
+// Maps normalized product IDs and categories to positions in the catalog
+struct CatalogIndex
+{
+    unordered_map<string, size_t> byID;
+    unordered_map<string, vector<size_t>> byCategory;
+    vector<string> categories;
+
+    void build(const vector<Product>& products)
+    {
+        byID.clear();
+        byCategory.clear();
+        categories.clear();
+        byID.reserve(products.size());
+        for (size_t i = 0; i < products.size(); ++i)
+        {
+            byID[products[i].getProductID()] = i;
+            byCategory[products[i].getCategory()].push_back(i);
+        }
+        for (const auto& category : byCategory)
+        {
+            categories.push_back(category.first);
+        }
+        sort(categories.begin(), categories.end());
+    }
+
+    // Moves a product's row to another category, keeping the row lists and categories sorted
+    void moveToCategory(size_t row, string oldCategory, const string& newCategory)
+    {
+        if (oldCategory == newCategory)
+        {
+            return;
+        }
+
+        vector<size_t>& oldRows = byCategory[oldCategory];
+        oldRows.erase(lower_bound(oldRows.begin(), oldRows.end(), row));
+        if (oldRows.empty())
+        {
+            byCategory.erase(oldCategory);
+            categories.erase(lower_bound(categories.begin(), categories.end(), oldCategory));
+        }
+
+        vector<size_t>& newRows = byCategory[newCategory];
+        if (newRows.empty())
+        {
+            categories.insert(lower_bound(categories.begin(), categories.end(), newCategory), newCategory);
+        }
+        newRows.insert(lower_bound(newRows.begin(), newRows.end(), row), row);
+    }
+};
+
+// Converts cart items into order lines that reference the catalog by position
+vector<OrderLine> toOrderLines(const ShoppingCart& cart, const CatalogIndex& index)
+{
+    vector<OrderLine> lines;
+    for (const auto& item : cart.getItems())
+    {
+        auto it = index.byID.find(item.first.getProductID());
+        if (it != index.byID.end())
+        {
+            lines.push_back({ static_cast<uint32_t>(it->second), item.second, item.first.getPrice() });
+        }
+    }
+    return lines;
+}
+
+struct ProductUpdate
+{
+    enum Target { ByID, ByCategory };
+    enum Operation { SetPrice, DiscountPercent, SetStock, AdjustStock };
+
+    Target target;
+    string key;
+    Operation operation;
+    double value;
+};
+
+struct BulkUpdateResult
+{
+    bool committed = false;
+    size_t rowsApplied = 0;
+    size_t unresolved = 0;
+    unsigned long version = 0;
+    vector<string> changedCategories;  // Categories with at least one product whose price or stock changed
+    string error;
+};
+
+// Work-stealing thread pool. Each worker owns a deque: it runs its own tasks
+// newest first and, when empty, steals the oldest task from another worker.
+// Tasks submitted with the same affinity key start on the same worker, so a
+// customer's cart tends to stay in that core's cache.
+//
+// The submit and complete paths touch only per-worker state: idleLock is taken
+// only when a worker is asleep, and allDone only while wait() is blocked.
+class TaskScheduler
+{
+private:
+    // Padded so one worker's queue and counters never share a cache line with another's
+    struct alignas(64) WorkerQueue
+    {
+        mutex lock;
+        deque<function<void()>> tasks;
+        atomic<size_t> submitted{0};  // Tasks submitted by this worker (to any queue)
+        atomic<size_t> completed{0};  // Tasks this worker has finished running
+    };
+
+    vector<unique_ptr<WorkerQueue>> queues;
+    vector<thread> workers;
+    mutex idleLock;
+    condition_variable wake;
+    condition_variable allDone;
+    atomic<size_t> sleeping;
+    atomic<size_t> waiters;
+    atomic<size_t> externalSubmitted;
+    atomic<size_t> nextQueue;
+    bool stopping;
+
+    // The scheduler and worker index of the calling thread, if it is a pool worker
+    static thread_local const TaskScheduler* currentScheduler;
+    static thread_local int currentWorker;
+
+    void push(size_t index, function<void()> task)
+    {
+        int worker = getCurrentWorker();
+        if (worker >= 0)
+        {
+            ++queues[worker]->submitted;
+        }
+        else
+        {
+            ++externalSubmitted;
+        }
+
+        {
+            lock_guard<mutex> guard(queues[index]->lock);
+            queues[index]->tasks.push_back(move(task));
+        }
+
+        // A worker going to sleep registers in sleeping before its last look at the
+        // queues, so either it sees this task or this check sees it
+        if (sleeping > 0)
+        {
+            lock_guard<mutex> guard(idleLock);
+            wake.notify_one();
+        }
+    }
+
+    bool popLocal(size_t index, function<void()>& task)
+    {
+        lock_guard<mutex> guard(queues[index]->lock);
+        if (queues[index]->tasks.empty())
+        {
+            return false;
+        }
+        task = move(queues[index]->tasks.back());
+        queues[index]->tasks.pop_back();
+        return true;
+    }
+
+    bool steal(size_t thief, function<void()>& task)
+    {
+        for (size_t offset = 1; offset < queues.size(); ++offset)
+        {
+            WorkerQueue& victim = *queues[(thief + offset) % queues.size()];
+            lock_guard<mutex> guard(victim.lock);
+            if (!victim.tasks.empty())
+            {
+                task = move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // True when every submitted task has finished. Completions are read before
+    // submissions, so a task still queued or running always makes the sums differ.
+    bool idle() const
+    {
+        size_t completed = 0;
+        for (const auto& queue : queues)
+        {
+            completed += queue->completed;
+        }
+        size_t submitted = externalSubmitted;
+        for (const auto& queue : queues)
+        {
+            submitted += queue->submitted;
+        }
+        return submitted == completed;
+    }
+
+    void run(size_t index, function<void()>& task)
+    {
+        task();
+        task = nullptr;
+        ++queues[index]->completed;
+    }
+
+    void workerLoop(size_t index)
+    {
+        currentScheduler = this;
+        currentWorker = static_cast<int>(index);
+        function<void()> task;
+        while (true)
+        {
+            if (popLocal(index, task) || steal(index, task))
+            {
+                run(index, task);
+                continue;
+            }
+
+            unique_lock<mutex> guard(idleLock);
+            ++sleeping;
+            if (popLocal(index, task) || steal(index, task))
+            {
+                --sleeping;
+                guard.unlock();
+                run(index, task);
+                continue;
+            }
+            if (waiters > 0)
+            {
+                allDone.notify_all();
+            }
+            if (stopping)
+            {
+                --sleeping;
+                return;
+            }
+            wake.wait(guard);
+            --sleeping;
+        }
+    }
+
+public:
+    // Constructor
+    TaskScheduler(size_t workerCount)
+        : sleeping(0), waiters(0), externalSubmitted(0), nextQueue(0), stopping(false)
+    {
+        workerCount = max<size_t>(1, workerCount);
+        for (size_t i = 0; i < workerCount; ++i)
+        {
+            queues.emplace_back(new WorkerQueue());
+        }
+        for (size_t i = 0; i < workerCount; ++i)
+        {
+            workers.emplace_back(&TaskScheduler::workerLoop, this, i);
+        }
+    }
+
+    // Destructor (finishes queued tasks before joining the workers)
+    ~TaskScheduler()
+    {
+        wait();
+        {
+            lock_guard<mutex> guard(idleLock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    // Queues a task on the worker that owns this affinity key
+    void submit(size_t affinity, function<void()> task) { push(affinity % queues.size(), move(task)); }
+
+    // Queues a task on the calling worker, or round-robin when called from outside this pool
+    void submit(function<void()> task)
+    {
+        int worker = getCurrentWorker();
+        size_t index = worker >= 0 ? static_cast<size_t>(worker) : nextQueue++ % queues.size();
+        push(index, move(task));
+    }
+
+    // Blocks until every submitted task, including ones submitted by tasks, has finished.
+    // Must not be called from one of this pool's own tasks.
+    void wait()
+    {
+        unique_lock<mutex> guard(idleLock);
+        ++waiters;
+        while (!idle())
+        {
+            allDone.wait(guard);
+        }
+        --waiters;
+    }
+
+    size_t getWorkerCount() const { return workers.size(); }
+
+    // Index of this pool's worker running the current task, or -1 on any other thread
+    int getCurrentWorker() const { return currentScheduler == this ? currentWorker : -1; }
+};
+
+thread_local const TaskScheduler* TaskScheduler::currentScheduler = nullptr;
+thread_local int TaskScheduler::currentWorker = -1;
+
+// Process-wide pool that parallelFor runs on
+TaskScheduler& sharedScheduler()
+{
+    static TaskScheduler scheduler(max(1u, thread::hardware_concurrency()));
+    return scheduler;
+}
+
+// Runs fn(partition) for each partition on the shared scheduler. The caller
+// claims partitions too, so it never waits on work that no worker has picked up;
+// it only waits for partitions already running elsewhere.
+template <typename Fn>
+void parallelFor(size_t partitions, Fn fn)
+{
+    if (partitions <= 1)
+    {
+        fn(0);
+        return;
+    }
+
+    // Shared with the helper tasks, which may start after this call has returned
+    struct Latch
+    {
+        atomic<size_t> next{0};
+        atomic<size_t> done{0};
+        mutex lock;
+        condition_variable finished;
+    };
+    auto latch = make_shared<Latch>();
+
+    auto work = [latch, partitions, &fn]()
+    {
+        size_t p;
+        while ((p = latch->next++) < partitions)
+        {
+            fn(p);
+            if (++latch->done == partitions)
+            {
+                lock_guard<mutex> guard(latch->lock);
+                latch->finished.notify_all();
+            }
+        }
+    };
+
+    TaskScheduler& scheduler = sharedScheduler();
+    for (size_t helper = 1; helper < min(partitions, scheduler.getWorkerCount() + 1); ++helper)
+    {
+        scheduler.submit(work);
+    }
+    work();
+
+    unique_lock<mutex> guard(latch->lock);
+    latch->finished.wait(guard, [&]() { return latch->done == partitions; });
+}
+
+// Applies a batch of price/stock updates as one catalog version.
+// Updates are resolved against the index in parallel, then each partition of
+// the catalog applies the rows it owns (in batch order) to a staged copy. If
+// any value is not finite, a stock value is not a whole number that fits in an int, or a product
+// would end up with a negative price or stock, nothing is written.
+BulkUpdateResult applyBulkUpdates(vector<Product>& products, const CatalogIndex& index,
+                                  const vector<ProductUpdate>& updates, size_t partitions)
+{
+    BulkUpdateResult result;
+    result.version = catalogVersion;
+
+    // Feed values are external input, so reject the batch before any of it is applied
+    for (const auto& update : updates)
+    {
+        if (!isfinite(update.value))
+        {
+            result.error = "Update value is not a finite number";
+            return result;
+        }
+        bool stockUpdate = update.operation == ProductUpdate::SetStock || update.operation == ProductUpdate::AdjustStock;
+        if (stockUpdate && (update.value < INT_MIN || update.value > INT_MAX))
+        {
+            result.error = "Stock update is outside the int range";
+            return result;
+        }
+        if (stockUpdate && update.value != trunc(update.value))
+        {
+            result.error = "Stock update is not a whole number";
+            return result;
+        }
+    }
+
+    partitions = max<size_t>(1, min(partitions, products.size()));
+    size_t rowsPerPartition = max<size_t>(1, (products.size() + partitions - 1) / partitions);
+    size_t updatesPerPartition = (updates.size() + partitions - 1) / partitions;
+
+    // resolved[r][p] holds (row, update) pairs found by resolver r for rows owned by partition p
+    vector<vector<vector<pair<size_t, size_t>>>> resolved(partitions, vector<vector<pair<size_t, size_t>>>(partitions));
+    vector<size_t> unresolved(partitions, 0);
+
+    parallelFor(partitions, [&](size_t r)
+    {
+        size_t begin = min(updates.size(), r * updatesPerPartition);
+        size_t end = min(updates.size(), begin + updatesPerPartition);
+        string key;
+
+        for (size_t u = begin; u < end; ++u)
+        {
+            key = updates[u].key;
+            if (updates[u].target == ProductUpdate::ByID)
+            {
+                toUpperCaseInPlace(key);
+                auto it = index.byID.find(key);
+                if (it == index.byID.end())
+                {
+                    ++unresolved[r];
+                    continue;
+                }
+                resolved[r][it->second / rowsPerPartition].push_back({it->second, u});
+            }
+            else
+            {
+                auto it = index.byCategory.find(key);
+                if (it == index.byCategory.end())
+                {
+                    ++unresolved[r];
+                    continue;
+                }
+                for (size_t row : it->second)
+                {
+                    resolved[r][row / rowsPerPartition].push_back({row, u});
+                }
+            }
+        }
+    });
+
+    vector<double> stagedPrice(products.size());
+    vector<long long> stagedStock(products.size());
+    vector<size_t> applied(partitions, 0);
+    vector<char> valid(partitions, 1);
+
+    parallelFor(partitions, [&](size_t p)
+    {
+        size_t begin = min(products.size(), p * rowsPerPartition);
+        size_t end = min(products.size(), begin + rowsPerPartition);
+        for (size_t row = begin; row < end; ++row)
+        {
+            stagedPrice[row] = products[row].getPrice();
+            stagedStock[row] = products[row].getStockQuantity();
+        }
+
+        // Resolvers own contiguous, ordered slices of the batch, so walking them in order keeps batch order
+        for (size_t r = 0; r < partitions; ++r)
+        {
+            for (const auto& rowUpdate : resolved[r][p])
+            {
+                const ProductUpdate& update = updates[rowUpdate.second];
+                size_t row = rowUpdate.first;
+                switch (update.operation)
+                {
+                case ProductUpdate::SetPrice:
+                    stagedPrice[row] = update.value;
+                    break;
+                case ProductUpdate::DiscountPercent:
+                    stagedPrice[row] *= 1.0 - update.value / 100.0;
+                    break;
+                case ProductUpdate::SetStock:
+                    stagedStock[row] = static_cast<long long>(update.value);
+                    break;
+                case ProductUpdate::AdjustStock:
+                    stagedStock[row] += static_cast<long long>(update.value);
+                    break;
+                }
+                ++applied[p];
+            }
+        }
+
+        for (size_t row = begin; row < end; ++row)
+        {
+            if (!isfinite(stagedPrice[row]) || stagedPrice[row] < 0 || stagedStock[row] < 0 || stagedStock[row] > INT_MAX)
+            {
+                valid[p] = 0;
+                break;
+            }
+        }
+    });
+
+    for (size_t p = 0; p < partitions; ++p)
+    {
+        result.unresolved += unresolved[p];
+        result.rowsApplied += applied[p];
+        if (!valid[p])
+        {
+            result.error = "Update would make a price or stock quantity invalid";
+        }
+    }
+
+    // Nothing to commit when the batch was rejected or matched no products
+    if (!result.error.empty() || result.rowsApplied == 0)
+    {
+        return result;
+    }
+
+    vector<vector<string>> changed(partitions);
+    parallelFor(partitions, [&](size_t p)
+    {
+        size_t begin = min(products.size(), p * rowsPerPartition);
+        size_t end = min(products.size(), begin + rowsPerPartition);
+        for (size_t row = begin; row < end; ++row)
+        {
+            Product& product = products[row];
+            if (product.getPrice() == stagedPrice[row] && product.getStockQuantity() == stagedStock[row])
+            {
+                continue;
+            }
+            if (find(changed[p].begin(), changed[p].end(), product.getCategory()) == changed[p].end())
+            {
+                changed[p].push_back(product.getCategory());
+            }
+            product.setPrice(stagedPrice[row]);
+            product.setStockQuantity(static_cast<int>(stagedStock[row]));
+        }
+    });
+
+    for (const auto& categories : changed)
+    {
+        result.changedCategories.insert(result.changedCategories.end(), categories.begin(), categories.end());
     }
+    sort(result.changedCategories.begin(), result.changedCategories.end());
+    result.changedCategories.erase(unique(result.changedCategories.begin(), result.changedCategories.end()), result.changedCategories.end());
 
-    double getTotalPrice() const { return totalPrice; }
-    int getCartID() const { return cartID; }
-    vector<pair<Product, int>> getItems() const { return items; }
-};
+    result.committed = true;
+    result.version = ++catalogVersion;
+    return result;
+}
 
-class Customer
+// LRU cache of rendered text with a byte budget. Each entry remembers how long it
+// took to render, so hits can be reported as render time saved.
+class RenderCache
 {
 private:
-    int customerID;
-    string name;
-    string email;
-    string address;
-
-public:
-    // Constructor
-    Customer(int id, string name, string email, string address)
-        : customerID(id), name(name), email(email), address(address) {}
+    struct Entry
+    {
+        string key;
+        string text;
+        double renderMicros;
+    };
 
-    // Getters
-    int getCustomerID() const { return customerID; }
-    string getName() const { return name; }
-    string getEmail() const { return email; }
-    string getAddress() const { return address; }
+    size_t byteBudget;
+    size_t bytesUsed;
+    list<Entry> entries;  // Most recently used first
+    unordered_map<string, list<Entry>::iterator> lookup;
+    string uncached;      // Holds a render too large to fit in the budget
 
-    // Setters
-    void setAddress(const string& newAddress) { address = newAddress; }
+    unsigned long hits;
+    unsigned long misses;
+    unsigned long evictions;
+    double microsSaved;
 
-    // To interact with the cart
-    void addToCart(Product product, ShoppingCart& cart, int quantity = 1)
-    {
-        cart.addProduct(product, quantity);
-    }
+    static size_t entryBytes(const Entry& entry) { return entry.key.size() + entry.text.size() + sizeof(Entry); }
 
-    void placeOrder(const ShoppingCart& cart)
+    void erase(unordered_map<string, list<Entry>::iterator>::iterator it)
     {
-        cout << "Order placed! Total Price: " << cart.getTotalPrice() << endl;
+        bytesUsed -= entryBytes(*it->second);
+        entries.erase(it->second);
+        lookup.erase(it);
     }
-};
-
-class Order
-{
-private:
-    int orderID;
-    Customer customer;
-    string orderDate;
-    vector<pair<Product, int>> products;
-    double totalAmount;
 
 public:
     // Constructor
-    Order(int id, const Customer& cust, const string& date, const vector<pair<Product, int>>& prodList)
-        : orderID(id), customer(cust), orderDate(date), products(prodList)
+    RenderCache(size_t budget)
+        : byteBudget(budget), bytesUsed(0), hits(0), misses(0), evictions(0), microsSaved(0) {}
+
+    // Returns the cached text for key, or calls render() and caches its result
+    template <typename Fn>
+    const string& getOrRender(const string& key, Fn render)
     {
-        totalAmount = 0;
-        for (const auto& p : products) 
+        auto it = lookup.find(key);
+        if (it != lookup.end())
+        {
+            ++hits;
+            microsSaved += it->second->renderMicros;
+            entries.splice(entries.begin(), entries, it->second);
+            return it->second->text;
+        }
+
+        ++misses;
+        auto start = chrono::steady_clock::now();
+        Entry entry = { key, render(), 0 };
+        entry.renderMicros = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+
+        size_t size = entryBytes(entry);
+        if (size > byteBudget)
+        {
+            uncached = move(entry.text);
+            return uncached;
+        }
+        while (bytesUsed + size > byteBudget)
         {
-            totalAmount += p.first.getPrice() * p.second;
+            erase(lookup.find(entries.back().key));
+            ++evictions;
         }
+
+        entries.push_front(move(entry));
+        lookup[key] = entries.begin();
+        bytesUsed += size;
+        return entries.front().text;
     }
 
-    void generateInvoice() const
+    void invalidate(const string& key)
     {
-        cout << "=========================" << endl;
-        cout << "        Invoice          " << endl;
-        cout << "=========================" << endl;
-        cout << "Order ID:  " << orderID << endl;
-        cout << "Order Date: " << orderDate << endl;
-        cout << "Order Details:" << endl;
-        cout << left;
-        cout << setw(12) << "Product ID" << setw(25) << "Name" << setw(10) << "Price" << setw(10) << "Quantity" << "Total" << endl;
-        cout << "----------------------------------------------" << endl;
-
-        for (const auto& p : products) 
-        {
-            cout << setw(12) << p.first.getProductID()
-                 << setw(25) << p.first.getName()
-                 << setw(10) << fixed << setprecision(2) << p.first.getPrice()
-                 << setw(10) << p.second
-                 << setw(10) << fixed << setprecision(2) << p.first.getPrice() * p.second << endl;
-        }
-        cout << "----------------------------------------------" << endl;
-        cout << "Total Amount: " << fixed << setprecision(2) << totalAmount << endl;
-        cout << "=========================" << endl;
+        auto it = lookup.find(key);
+        if (it != lookup.end())
+        {
+            erase(it);
+        }
     }
+
+    unsigned long getHits() const { return hits; }
+    unsigned long getMisses() const { return misses; }
+    unsigned long getEvictions() const { return evictions; }
+    double getMicrosSaved() const { return microsSaved; }
 };
 
-string toUpperCase(const string& str) 
+RenderCache renderCache(1 << 20);
+
+// Listing blocks are keyed by category alone and invalidated whenever one of
+// their products' stock, price or category changes.
+string listingKey(const string& category) { return "listing:" + category; }
+
+// Drops the listing blocks of the categories a bulk update changed
+void invalidateListings(RenderCache& cache, const vector<string>& categories)
 {
-    string result;
-    result.reserve(str.size());
-    for (char ch : str) 
+    for (const auto& category : categories)
     {
-        result.push_back(std::toupper(static_cast<unsigned char>(ch)));
+        cache.invalidate(listingKey(category));
     }
-    return result;
 }
 
-void viewProducts(vector<Product>& products, ShoppingCart& cart)
+// Moves a product to another category, keeping the index and both listing blocks in step
+void setProductCategory(vector<Product>& products, CatalogIndex& index, RenderCache& cache, size_t row, const string& newCategory)
+{
+    string oldCategory = products[row].getCategory();
+    products[row].setCategory(newCategory);
+    index.moveToCategory(row, oldCategory, newCategory);
+    cache.invalidate(listingKey(oldCategory));
+    cache.invalidate(listingKey(newCategory));
+}
+
+string invoiceKey(int orderID) { return "invoice:" + to_string(orderID); }
+
+string renderCategoryListing(const string& category, const vector<Product>& products, const CatalogIndex& index)
+{
+    ostringstream out;
+    out << left;
+    out << endl << category << endl;
+    out << "-------------------------" << endl;
+
+    for (size_t row : index.byCategory.at(category))
+    {
+        const Product& product = products[row];
+        out << setw(12) << product.getProductID()
+            << setw(25) << product.getName()
+            << setw(10) << fixed << setprecision(2) << product.getPrice()
+            << setw(10) << product.getStockQuantity() << endl;
+    }
+
+    out << "-------------------------" << endl;
+    return out.str();
+}
+
+void viewProducts(vector<Product>& products, const CatalogIndex& index, ShoppingCart& cart)
 {
     cout << "=========================" << endl;
     cout << "        Products          " << endl;
@@ -179,27 +1119,13 @@ void viewProducts(vector<Product>& products, ShoppingCart& cart)
     cout << left << setw(12) << "Product ID" << setw(25) << "Name" << setw(10) << "Price" << setw(10) << "Stock" << endl;  
     cout << "----------------------------------------------" << endl;
 
-    // Group products by category and print headers
-    map<string, vector<Product>> productsByCategory;
-    for (const auto& product : products) 
+    // Print each category block, re-rendering only those whose products changed
+    for (const auto& category : index.categories) 
     {
-        productsByCategory[product.getCategory()].push_back(product);
-    }
-
-    for (const auto& categoryPair : productsByCategory) 
-    {
-        cout << endl << categoryPair.first << endl;
-        cout << "-------------------------" << endl;
-
-        for (const auto& product : categoryPair.second) 
+        cout << renderCache.getOrRender(listingKey(category), [&]() 
         {
-            cout << setw(12) << product.getProductID()
-                 << setw(25) << product.getName()
-                 << setw(10) << fixed << setprecision(2) << product.getPrice()
-                 << setw(10) << product.getStockQuantity() << endl;
-        }
-
-        cout << "-------------------------" << endl;
+            return renderCategoryListing(category, products, index);
+        });
     }
 
     string productID;
@@ -210,9 +1136,6 @@ void viewProducts(vector<Product>& products, ShoppingCart& cart)
         cout << "Enter the ID of the product you want to add to the shopping cart (or enter -1 to cancel): ";
         cin >> productID;
 
-        // Convert productID to uppercase for comparison
-        productID = toUpperCase(productID);
-
         // Check if the user wants to cancel
         if (productID == "-1") 
         {
@@ -220,11 +1143,10 @@ void viewProducts(vector<Product>& products, ShoppingCart& cart)
             return;  // Exit the function and return to the menu
         }
 
-        // Find the product
-        auto it = find_if(products.begin(), products.end(), [&](const Product& p) 
-        {
-            return toUpperCase(p.getProductID()) == productID;
-        });
+        // Catalog IDs are normalized at load, so fold the query once and look it up in the index
+        toUpperCaseInPlace(productID);
+        auto found = index.byID.find(productID);
+        auto it = found != index.byID.end() ? products.begin() + found->second : products.end();
 
         if (it != products.end())
         {
@@ -232,6 +1154,7 @@ void viewProducts(vector<Product>& products, ShoppingCart& cart)
             {
                 cart.addProduct(*it, 1); // Add product with default quantity 1
                 it->decreaseStock(1); // Decrease stock quantity
+                renderCache.invalidate(listingKey(it->getCategory()));
                 cout << "Product added successfully!" << endl;
             } 
             else 
@@ -264,7 +1187,7 @@ void viewProducts(vector<Product>& products, ShoppingCart& cart)
     while (addAnother == 'Y' || addAnother == 'y');
 }
 
-void viewShoppingCart(ShoppingCart& cart, Customer& customer)
+void viewShoppingCart(ShoppingCart& cart, Customer& customer, const vector<Product>& products, const CatalogIndex& index)
 {
     cout << "=========================" << endl;
     cout << "      Shopping Cart      " << endl;
@@ -293,19 +1216,11 @@ void viewShoppingCart(ShoppingCart& cart, Customer& customer)
         if (checkOut == 'Y' || checkOut == 'y')
         {
             // Create an order
-            static int nextOrderID = 1;
-            time_t now = time(0);
-            tm* ltm = localtime(&now);
-            string orderDate = to_string(1900 + ltm->tm_year) + "-" 
-                             + (ltm->tm_mon + 1 < 10 ? "0" : "") + to_string(ltm->tm_mon + 1) + "-" 
-                             + (ltm->tm_mday < 10 ? "0" : "") + to_string(ltm->tm_mday);
-
-            Order newOrder(nextOrderID++, customer, orderDate, cart.getItems());
-            newOrder.generateInvoice();
-            orderList.push_back(newOrder);
+            const Order& newOrder = orderStore.addOrder(customer.getCustomerID(), currentOrderDate(), toOrderLines(cart, index));
+            cout << orderStore.renderInvoice(newOrder, products);
 
             // Clear the cart after checkout
-            cart = ShoppingCart(cart.getCartID()); 
+            cart.clear();
 
             cout << "You have successfully checked out the products!" << endl;
             return;
@@ -323,30 +1238,341 @@ void viewShoppingCart(ShoppingCart& cart, Customer& customer)
     while (checkOut != 'Y' && checkOut != 'y' && checkOut != 'N' && checkOut != 'n');
 }
 
-void placeOrder(Customer& customer, ShoppingCart& cart)
+// Previews the invoice for the current cart (the order is only stored at checkout),
+// or shows the customer's most recent order when the cart is empty
+void placeOrder(Customer& customer, ShoppingCart& cart, const vector<Product>& products, const CatalogIndex& index)
 {
-    static int nextOrderID = 1;
+    vector<OrderLine> lines = toOrderLines(cart, index);
+    if (lines.empty())
+    {
+        const vector<uint32_t>& history = orderStore.ordersForCustomer(customer.getCustomerID());
+        if (history.empty())
+        {
+            cout << "Your shopping cart is empty." << endl;
+            return;
+        }
 
-    // Get current time
-    time_t now = time(0);
-    tm* ltm = localtime(&now);
+        // Placed orders never change, so their invoices are cached by order ID alone
+        const Order& order = *orderStore.findOrder(history.back());
+        cout << renderCache.getOrRender(invoiceKey(order.getOrderID()), [&]() 
+        {
+            return orderStore.renderInvoice(order, products);
+        });
+        cout << "Order viewed successfully!" << endl;
+        return;
+    }
 
-    // Format order date as YYYY-MM-DD
-    string orderDate = to_string(1900 + ltm->tm_year) + "-" 
-                     + (ltm->tm_mon + 1 < 10 ? "0" : "") + to_string(ltm->tm_mon + 1) + "-" 
-                     + (ltm->tm_mday < 10 ? "0" : "") + to_string(ltm->tm_mday);
+    // The preview shows the ID and date the order would get at checkout, and is re-rendered
+    // only when the cart, the next order ID or the date changes
+    static string lastPreviewKey;
+    int nextOrderID = static_cast<int>(orderStore.size() + 1);
+    int orderDate = currentOrderDate();
+    string key = "preview:" + to_string(cart.getCartID()) + "@" + to_string(cart.getRevision())
+               + "#" + to_string(nextOrderID) + "@" + to_string(orderDate);
+    if (key != lastPreviewKey)
+    {
+        renderCache.invalidate(lastPreviewKey);
+        lastPreviewKey = key;
+    }
 
-    Order newOrder(nextOrderID++, customer, orderDate, cart.getItems());
-    newOrder.generateInvoice();
-    orderList.push_back(newOrder);
+    cout << renderCache.getOrRender(key, [&]() 
+    {
+        return renderInvoiceLines(nextOrderID, orderDate, lines.data(), lines.size(), products);
+    });
 
     cout << "Order viewed successfully!" << endl;
 }
 
-int main()
+// Times the old allocating comparison against equalsIgnoreCase for one input size
+void benchmarkCaseFold(const string& label, size_t length, int iterations)
 {
-    srand(static_cast<unsigned>(time(0)));  // Seed random number generator
+    string lower(length, 'a');
+    for (size_t i = 0; i < length; ++i)
+    {
+        lower[i] = static_cast<char>('a' + i % 26);
+    }
+    string upper = lower;
+    for (char& ch : upper)
+    {
+        ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+    }
+
+    volatile int matches = 0;
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        string folded;
+        folded.reserve(lower.size());
+        for (char ch : lower)
+        {
+            folded.push_back(std::toupper(static_cast<unsigned char>(ch)));
+        }
+        matches += (folded == upper);
+    }
+    auto scalarTime = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / iterations;
+
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        matches += equalsIgnoreCase(lower, upper);
+    }
+    auto compareTime = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / iterations;
+
+    string scratch = lower;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        scratch[0] = 'a';
+        toUpperCaseInPlace(scratch);
+    }
+    auto foldTime = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / iterations;
+
+    cout << left << setw(14) << label << setw(8) << length
+         << setw(16) << fixed << setprecision(1) << scalarTime
+         << setw(16) << compareTime
+         << setw(16) << foldTime << endl;
+}
+
+void runCaseFoldBenchmark()
+{
+#if defined(__AVX2__)
+    cout << "Case folding benchmark (AVX2)" << endl;
+#elif defined(__SSE2__)
+    cout << "Case folding benchmark (SSE2)" << endl;
+#else
+    cout << "Case folding benchmark (scalar)" << endl;
+#endif
+    cout << left << setw(14) << "Input" << setw(8) << "Bytes" << setw(16) << "toupper ns" << setw(16) << "compare ns" << setw(16) << "in-place ns" << endl;
+    cout << "----------------------------------------------------------------------" << endl;
+    benchmarkCaseFold("Short ID", 4, 2000000);
+    benchmarkCaseFold("Long ID", 16, 2000000);
+    benchmarkCaseFold("Name", 64, 1000000);
+    benchmarkCaseFold("Long name", 1024, 100000);
+}
+
+// Replays a 1M-row feed against a 1M-product catalog at increasing partition counts
+void runBulkUpdateBenchmark()
+{
+    const size_t catalogSize = 1000000;
+    const size_t feedSize = 1000000;
+    const vector<string> categories = { "Electronics", "Home Appliances", "Fashion", "Beauty and Personal Care" };
+
+    vector<Product> catalog;
+    catalog.reserve(catalogSize);
+    for (size_t i = 0; i < catalogSize; ++i)
+    {
+        catalog.emplace_back("P" + to_string(1000000 + i), "Product " + to_string(i), 1000.0 + i % 5000, 100, categories[i % categories.size()]);
+    }
+
+    CatalogIndex index;
+    index.build(catalog);
+
+    vector<ProductUpdate> feed;
+    feed.reserve(feedSize);
+    for (size_t i = 0; i < feedSize; ++i)
+    {
+        string id = "p" + to_string(1000000 + (i * 7919) % catalogSize);
+        if (i % 2 == 0)
+        {
+            feed.push_back({ ProductUpdate::ByID, id, ProductUpdate::SetStock, static_cast<double>(50 + i % 50) });
+        }
+        else
+        {
+            feed.push_back({ ProductUpdate::ByID, id, ProductUpdate::AdjustStock, -1 });
+        }
+    }
+    feed.push_back({ ProductUpdate::ByCategory, "Fashion", ProductUpdate::DiscountPercent, 10 });
+
+    size_t maxThreads = max(1u, thread::hardware_concurrency());
+    cout << "Bulk update benchmark: " << feed.size() << " updates, " << catalogSize << " products" << endl;
+    cout << left << setw(10) << "Threads" << setw(14) << "Time (ms)" << setw(16) << "Rows/s" << "Version" << endl;
+    cout << "----------------------------------------------" << endl;
+
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        auto start = chrono::steady_clock::now();
+        BulkUpdateResult result = applyBulkUpdates(catalog, index, feed, threads);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        if (!result.committed)
+        {
+            cout << "Batch rejected: " << result.error << endl;
+            return;
+        }
+        cout << setw(10) << threads << setw(14) << fixed << setprecision(1) << ms
+             << setw(16) << setprecision(0) << result.rowsApplied / (ms / 1000.0) << result.version << endl;
+    }
+}
+
+// Loads synthetic orders (50M by default) and times per-customer and per-date history queries
+void runOrderIndexBenchmark(size_t orderCount)
+{
+    const int customerCount = 1000000;
+    const int catalogSize = 30;
+    const int dayCount = 1000;
+
+    vector<Product> catalog;
+    for (int i = 0; i < catalogSize; ++i)
+    {
+        catalog.emplace_back("P" + to_string(i), "Product " + to_string(i), 1000.0 + i, 100, "Bench");
+    }
+
+    OrderStore store;
+    store.reserve(orderCount, orderCount);
+    vector<OrderLine> orderLines(1);
+    unsigned seed = 12345;
+
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < orderCount; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        int day = static_cast<int>(i * dayCount / orderCount);
+        int date = (2022 + day / 336) * 10000 + (day / 28 % 12 + 1) * 100 + day % 28 + 1;
+        orderLines[0] = { static_cast<uint32_t>(seed % catalogSize), 1, catalog[seed % catalogSize].getPrice() };
+        store.addOrder(static_cast<int>((seed >> 8) % customerCount) + 1, date, orderLines);
+    }
+    double loadMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    const int queries = 100000;
+    size_t found = 0;
+    volatile double revenue = 0;
+    start = chrono::steady_clock::now();
+    for (int q = 0; q < queries; ++q)
+    {
+        seed = seed * 1103515245 + 12345;
+        for (uint32_t orderID : store.ordersForCustomer(static_cast<int>((seed >> 8) % customerCount) + 1))
+        {
+            revenue += store.findOrder(orderID)->getTotalAmount();
+            ++found;
+        }
+    }
+    double customerUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / queries;
+
+    start = chrono::steady_clock::now();
+    size_t onDate = store.ordersOnDate(20220513).size();
+    double dateUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    size_t both = 0;
+    for (int q = 0; q < queries; ++q)
+    {
+        seed = seed * 1103515245 + 12345;
+        both += store.ordersForCustomerOnDate(static_cast<int>((seed >> 8) % customerCount) + 1, 20220513).size();
+    }
+    double bothUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / queries;
+
+    cout << "Order index benchmark: " << store.size() << " orders, " << customerCount << " customers" << endl;
+    cout << fixed << setprecision(2);
+    cout << "Load:                        " << loadMs << " ms" << endl;
+    cout << "Customer history (avg " << found / queries << " orders): " << customerUs << " us/query" << endl;
+    cout << "Orders on 2022-05-13 (" << onDate << "):    " << dateUs << " us" << endl;
+    cout << "Customer + date (" << both << " hits):   " << bothUs << " us/query" << endl;
+}
+
+// Replays a read-heavy mix of listing and invoice views with occasional stock changes
+void runRenderCacheBenchmark()
+{
+    const vector<string> categories = { "Electronics", "Home Appliances", "Fashion", "Beauty and Personal Care",
+                                        "Books", "Toys", "Groceries", "Sports" };
+    const int productCount = 800;
+    const int orderCount = 2000;
+    const int operations = 100000;
+
+    vector<Product> catalog;
+    for (int i = 0; i < productCount; ++i)
+    {
+        catalog.emplace_back("P" + to_string(1000 + i), "Product " + to_string(i), 100.0 + i, 1000000, categories[i % categories.size()]);
+    }
+    CatalogIndex index;
+    index.build(catalog);
+
+    OrderStore store;
+    vector<OrderLine> lines;
+    for (int i = 0; i < orderCount; ++i)
+    {
+        lines.clear();
+        for (int j = 0; j < 1 + i % 5; ++j)
+        {
+            uint32_t row = static_cast<uint32_t>((i * 31 + j * 7) % productCount);
+            lines.push_back({ row, 1 + j, catalog[row].getPrice() });
+        }
+        store.addOrder(1 + i % 100, currentOrderDate(), lines);
+    }
+
+    const vector<Product> initialCatalog = catalog;
+    size_t bytes = 0;
+
+    // Runs the same seeded workload from the same starting catalog; a zero budget renders every view
+    auto replay = [&](RenderCache& cache)
+    {
+        catalog = initialCatalog;
+        index.build(catalog);
+        unsigned seed = 42;
+        auto start = chrono::steady_clock::now();
+        for (int op = 0; op < operations; ++op)
+        {
+            seed = seed * 1103515245 + 12345;
+            unsigned pick = (seed >> 8) % 100;
+            if (pick < 8)
+            {
+                // Stock change on one product invalidates only its category's block
+                Product& product = catalog[(seed >> 12) % productCount];
+                product.decreaseStock(1);
+                cache.invalidate(listingKey(product.getCategory()));
+            }
+            else if (pick == 8)
+            {
+                // Category-wide price change through the bulk path
+                const string& category = index.categories[(seed >> 12) % index.categories.size()];
+                vector<ProductUpdate> updates = { { ProductUpdate::ByCategory, category, ProductUpdate::DiscountPercent, op % 2 ? 1.0 : -1.0 } };
+                invalidateListings(cache, applyBulkUpdates(catalog, index, updates, 1).changedCategories);
+            }
+            else if (pick == 9)
+            {
+                setProductCategory(catalog, index, cache, (seed >> 12) % productCount, categories[(seed >> 4) % categories.size()]);
+            }
+            else if (pick < 50)
+            {
+                const string& category = index.categories[(seed >> 12) % index.categories.size()];
+                bytes += cache.getOrRender(listingKey(category), [&]() { return renderCategoryListing(category, catalog, index); }).size();
+            }
+            else
+            {
+                // Invoice views are skewed towards recent orders
+                int orderID = orderCount - static_cast<int>(((seed >> 12) % orderCount) * ((seed >> 4) % orderCount) / orderCount);
+                const Order& order = *store.findOrder(orderID);
+                bytes += cache.getOrRender(invoiceKey(orderID), [&]() { return store.renderInvoice(order, catalog); }).size();
+            }
+        }
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    };
+
+    cout << "Render cache benchmark: " << operations << " operations, 90% reads" << endl;
+    RenderCache noCache(0);
+    cout << "Uncached: " << fixed << setprecision(1) << replay(noCache) << " ms" << endl;
+    cout << left << setw(12) << "Budget KB" << setw(10) << "Hit %" << setw(12) << "Evictions"
+         << setw(14) << "Saved ms" << "Cached ms" << endl;
+    cout << "----------------------------------------------------------" << endl;
 
+    for (size_t budgetKB : { 16, 64, 256, 1024 })
+    {
+        RenderCache cache(budgetKB * 1024);
+        double cachedMs = replay(cache);
+        double hitRate = 100.0 * cache.getHits() / max<unsigned long>(1, cache.getHits() + cache.getMisses());
+        cout << setw(12) << budgetKB << setw(10) << hitRate
+             << setw(12) << cache.getEvictions() << setw(14) << cache.getMicrosSaved() / 1000.0
+             << cachedMs << endl;
+    }
+    if (bytes == 0)
+    {
+        cout << "No output rendered" << endl;
+    }
+}
+
+// The demo catalog, with random stock levels
+vector<Product> loadCatalog()
+{
     vector<Product> products = {
         Product("P001", "iPhone 14 Pro Max", 89990, rand() % 50 + 1, "Electronics"),
         Product("P002", "Samsung Galaxy S23 Ultra", 74990, rand() % 50 + 1, "Electronics"),
@@ -380,6 +1606,218 @@ int main()
         Product("P030", "Hair Styling Products", 1500, rand() % 50 + 1, "Beauty and Personal Care")
     };
 
+    for (auto& product : products)
+    {
+        product.normalizeID();
+    }
+    return products;
+}
+
+// Per-worker analytics totals, padded so workers never share a cache line
+struct alignas(64) SimulationStats
+{
+    unsigned long checkouts = 0;
+    unsigned long rejected = 0;
+    unsigned long units = 0;
+    double revenue = 0;
+    size_t invoiceBytes = 0;
+};
+
+// Drives synthetic customers through addProduct, checkout, invoice rendering and
+// analytics as tasks on a TaskScheduler, for worker counts up to maxThreads
+void runCheckoutSimulation(size_t customerCount, size_t maxThreads)
+{
+    const vector<Product> catalog = loadCatalog();
+    CatalogIndex index;
+    index.build(catalog);
+
+    vector<size_t> threadCounts;
+    for (size_t threads = 1; threads < maxThreads; threads *= 2)
+    {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    cout << "Checkout simulation: " << customerCount << " customers, " << catalog.size() << " products" << endl;
+    cout << left << setw(10) << "Threads" << setw(14) << "Time (ms)" << setw(18) << "Checkouts/s"
+         << setw(10) << "Speedup" << "Revenue" << endl;
+    cout << "----------------------------------------------------------" << endl;
+
+    double baselineMs = 0;
+    for (size_t threads : threadCounts)
+    {
+        // Simulated stock is large so runs are comparable; reservations are atomic
+        unique_ptr<atomic<int>[]> stock(new atomic<int>[catalog.size()]);
+        for (size_t i = 0; i < catalog.size(); ++i)
+        {
+            stock[i] = 1000000000;
+        }
+
+        vector<ShoppingCart> carts;
+        carts.reserve(customerCount);
+        for (size_t c = 0; c < customerCount; ++c)
+        {
+            carts.emplace_back(static_cast<int>(c + 1));
+        }
+
+        // Each worker writes orders to its own shard; the shards are merged after the run
+        vector<OrderStore> shards(threads);
+        for (auto& shard : shards)
+        {
+            shard.reserve(customerCount / threads + 1, (customerCount / threads + 1) * 4);
+        }
+        OrderStore store;
+        int orderDate = currentOrderDate();
+        vector<SimulationStats> stats(threads);
+
+        auto start = chrono::steady_clock::now();
+        {
+            TaskScheduler scheduler(threads);
+
+            for (size_t c = 0; c < customerCount; ++c)
+            {
+                // Each worker owns a contiguous block of customers, so neighbouring carts
+                // (which share cache lines) are written by the same core
+                size_t owner = c * threads / customerCount;
+                scheduler.submit(owner, [&, c, owner]()
+                {
+                    // Cart mutations
+                    ShoppingCart& cart = carts[c];
+                    unsigned seed = static_cast<unsigned>(c) * 2654435761u + 1;
+                    for (int item = 0; item < 1 + static_cast<int>(c % 4); ++item)
+                    {
+                        seed = seed * 1103515245 + 12345;
+                        cart.addProduct(catalog[(seed >> 8) % catalog.size()], 1 + (seed >> 20) % 3);
+                    }
+
+                    // Checkout, keeping this customer's work on the same worker
+                    scheduler.submit(owner, [&, c]()
+                    {
+                        ShoppingCart& cart = carts[c];
+                        int worker = scheduler.getCurrentWorker();
+                        SimulationStats& local = stats[worker];
+                        vector<OrderLine> lines = toOrderLines(cart, index);
+
+                        size_t reserved = 0;
+                        for (; reserved < lines.size(); ++reserved)
+                        {
+                            atomic<int>& available = stock[lines[reserved].productIndex];
+                            if (available.fetch_sub(lines[reserved].quantity) < lines[reserved].quantity)
+                            {
+                                available += lines[reserved].quantity;
+                                break;
+                            }
+                        }
+                        if (reserved < lines.size())
+                        {
+                            for (size_t i = 0; i < reserved; ++i)
+                            {
+                                stock[lines[i].productIndex] += lines[i].quantity;
+                            }
+                            ++local.rejected;
+                            return;
+                        }
+
+                        int orderID = shards[worker].addOrder(static_cast<int>(c + 1), orderDate, lines).getOrderID();
+                        cart.clear();
+
+                        // Invoice rendering from the captured lines (no store access), then analytics
+                        // aggregation into this worker's totals. The invoice shows the shard-local
+                        // order ID, since the merge below renumbers orders.
+                        scheduler.submit([&, orderID, lines]()
+                        {
+                            SimulationStats& local = stats[scheduler.getCurrentWorker()];
+                            local.invoiceBytes += renderInvoiceLines(orderID, orderDate, lines.data(), lines.size(), catalog).size();
+
+                            scheduler.submit([&, lines]()
+                            {
+                                SimulationStats& local = stats[scheduler.getCurrentWorker()];
+                                ++local.checkouts;
+                                for (const auto& line : lines)
+                                {
+                                    local.units += line.quantity;
+                                    local.revenue += line.unitPrice * line.quantity;
+                                }
+                            });
+                        });
+                    });
+                });
+            }
+
+            scheduler.wait();
+        }
+        for (const auto& shard : shards)
+        {
+            store.append(shard);
+        }
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        SimulationStats total;
+        for (const auto& local : stats)
+        {
+            total.checkouts += local.checkouts;
+            total.rejected += local.rejected;
+            total.units += local.units;
+            total.revenue += local.revenue;
+            total.invoiceBytes += local.invoiceBytes;
+        }
+        if (baselineMs == 0)
+        {
+            baselineMs = ms;
+        }
+
+        cout << setw(10) << threads << setw(14) << fixed << setprecision(1) << ms
+             << setw(18) << setprecision(0) << total.checkouts / (ms / 1000.0)
+             << setw(10) << setprecision(2) << baselineMs / ms
+             << setprecision(2) << total.revenue << endl;
+        if (total.checkouts + total.rejected != customerCount)
+        {
+            cout << "Simulation lost " << customerCount - total.checkouts - total.rejected << " checkouts!" << endl;
+        }
+        if (store.size() != total.checkouts)
+        {
+            cout << "Merged order store has " << store.size() << " orders for " << total.checkouts << " checkouts!" << endl;
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && string(argv[1]) == "--bench-case")
+    {
+        runCaseFoldBenchmark();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-bulk")
+    {
+        runBulkUpdateBenchmark();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-orders")
+    {
+        runOrderIndexBenchmark(argc > 2 ? stoul(argv[2]) : 50000000);
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--bench-cache")
+    {
+        runRenderCacheBenchmark();
+        return 0;
+    }
+    if (argc > 1 && string(argv[1]) == "--simulate")
+    {
+        srand(static_cast<unsigned>(time(0)));
+        size_t maxThreads = argc > 3 ? stoul(argv[3]) : max(1u, thread::hardware_concurrency());
+        runCheckoutSimulation(argc > 2 ? stoul(argv[2]) : 100000, max<size_t>(1, maxThreads));
+        return 0;
+    }
+
+    srand(static_cast<unsigned>(time(0)));  // Seed random number generator
+
+    vector<Product> products = loadCatalog();
+
+    CatalogIndex catalogIndex;
+    catalogIndex.build(products);
+
     vector<Customer> customers = {
         Customer(1, "Alice Smith", "alice.smith@example.com", "123 Main St"),
         Customer(2, "Bob Johnson", "bob.johnson@example.com", "456 Oak Ave")
@@ -406,13 +1844,13 @@ int main()
         switch (option)
         {
         case 1:
-            viewProducts(products, carts[0]); // Assuming user 1's cart
+            viewProducts(products, catalogIndex, carts[0]); // Assuming user 1's cart
             break;
         case 2:
-            viewShoppingCart(carts[0], customers[0]); // Assuming user 1's cart and customer
+            viewShoppingCart(carts[0], customers[0], products, catalogIndex); // Assuming user 1's cart and customer
             break;
         case 3:
-            placeOrder(customers[0], carts[0]); // Assuming user 1's cart
+            placeOrder(customers[0], carts[0], products, catalogIndex); // Assuming user 1's cart and customer
             break;
         case 4:
             cout << "Exiting..." << endl;